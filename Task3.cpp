@@ -5,6 +5,13 @@
 #include <cmath>
 #include <iomanip>
 #include <sstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <memory>
 
 const int WINDOW_WIDTH = 1500;
 const int WINDOW_HEIGHT = 800;
@@ -29,9 +36,38 @@ struct LineSegment {
     Point p1, p2;
 };
 
+struct ClipResult {
+    bool visible;
+    LineSegment clipped;
+};
+
 std::vector<Point> visible_points;
 std::vector<LineSegment> lines_to_clip;
 
+// Pipelined ingestion (--pipeline): results are published in order through
+// published_count, so display() can read them while the parser and clip
+// worker threads are still running.
+bool use_pipeline = false;
+std::atomic<size_t> published_count(0);
+std::atomic<bool> pipeline_done(false);
+std::atomic<bool> pipeline_stop(false); // set when the window closes
+std::thread clip_thread;
+size_t drawn_count = 0; // segments already on screen (GL thread only)
+
+// Software raster (--raster): clipped spans go straight into framebuffer
+// instead of GL_LINES. raster_ready publishes the finished framebuffer to
+// display(); while the pipeline runs, partial rasters are handed over through
+// the raster_snapshot mailbox (see publish_raster_snapshot).
+bool use_raster = false;
+std::vector<unsigned char> framebuffer;     // written by the rasterizing thread
+std::vector<unsigned char> raster_snapshot; // worker -> GL thread mailbox
+std::vector<unsigned char> raster_front;    // GL thread only
+std::atomic<unsigned> snapshot_generation(0);
+std::atomic<bool> snapshot_wanted(true);
+unsigned shown_generation = 0;              // GL thread only
+std::atomic<bool> raster_ready(false);
+size_t rasterized_visible = 0;
+
 float xmin, ymin, xmax, ymax;
 
 // ------------------- Helper Functions -------------------
@@ -135,10 +171,11 @@ void draw_clipping_window() {
 }
 
 // ------------------- Liang–Barsky -------------------
-bool liang_barsky(float x0, float y0, float x1, float y1, float &t0, float &t1) {
+bool liang_barsky_rect(float wxmin, float wymin, float wxmax, float wymax,
+                       float x0, float y0, float x1, float y1, float &t0, float &t1) {
     float dx = x1 - x0, dy = y1 - y0;
     float p[4] = {-dx, dx, -dy, dy};
-    float q[4] = {x0 - xmin, xmax - x0, y0 - ymin, ymax - y0};
+    float q[4] = {x0 - wxmin, wxmax - x0, y0 - wymin, wymax - y0};
     t0 = 0.0f, t1 = 1.0f;
 
     for (int i = 0; i < 4; ++i) {
@@ -153,43 +190,340 @@ bool liang_barsky(float x0, float y0, float x1, float y1, float &t0, float &t1)
     return t0 <= t1;
 }
 
-// ------------------- Display -------------------
-void display() {
-    glClear(GL_COLOR_BUFFER_BIT);
-    visible_points.clear();
+bool liang_barsky(float x0, float y0, float x1, float y1, float &t0, float &t1) {
+    return liang_barsky_rect(xmin, ymin, xmax, ymax, x0, y0, x1, y1, t0, t1);
+}
 
-    draw_ui_header(
-        "Liang–Barsky Line Clipping (Modified Version)",
-        "Clipping Window: (" + std::to_string(xmin) + "," + std::to_string(ymin) +
-        ") → (" + std::to_string(xmax) + "," + std::to_string(ymax) + ")",
-        0.0f, 0.4f, 0.7f
-    );
+ClipResult clip_segment(const LineSegment &line) {
+    float x0 = line.p1.x, y0 = line.p1.y;
+    float x1 = line.p2.x, y1 = line.p2.y;
+    float t0, t1;
+    ClipResult r = {false, line};
 
-    draw_coordinate_system();
-    draw_clipping_window();
+    if (!liang_barsky(x0, y0, x1, y1, t0, t1)) return r;
+
+    r.visible = true;
+    r.clipped.p1 = {x0 + t0 * (x1 - x0), y0 + t0 * (y1 - y0)};
+    r.clipped.p2 = {x0 + t1 * (x1 - x0), y0 + t1 * (y1 - y0)};
+    return r;
+}
+
+// ------------------- Clip + Rasterize -------------------
+// One RGB texel per world unit over the drawing area; row 0 is the bottom.
+const int FB_WIDTH = (int)DRAWING_AREA_WIDTH;
+const int FB_HEIGHT = (int)DRAWING_AREA_HEIGHT;
+const int FB_ORIGIN_X = (int)OPENGL_MIN_X;
+const int FB_ORIGIN_Y = (int)OPENGL_MIN_Y;
+const int FB_LAST_X = FB_ORIGIN_X + FB_WIDTH - 1;
+const int FB_LAST_Y = FB_ORIGIN_Y + FB_HEIGHT - 1;
+
+void clear_framebuffer() {
+    framebuffer.assign(FB_WIDTH * FB_HEIGHT * 3, 255); // white, matches glClearColor
+}
+
+inline void fb_plot(int x, int y) {
+    int px = x - FB_ORIGIN_X;
+    int py = y - FB_ORIGIN_Y;
+    assert(px >= 0 && px < FB_WIDTH && py >= 0 && py < FB_HEIGHT);
+
+    unsigned char *c = &framebuffer[(py * FB_WIDTH + px) * 3];
+    c[0] = 255; c[1] = 153; c[2] = 0; // orange, same as the GL clipped segments
+}
 
-    for (auto &line : lines_to_clip) {
-        float x0 = line.p1.x, y0 = line.p1.y;
-        float x1 = line.p2.x, y1 = line.p2.y;
+// Integer Bresenham, the same kernel as Task1's bresenhamStandard,
+// writing into the framebuffer instead of issuing GL_POINTS.
+void bresenham_fb(int x1, int y1, int x2, int y2) {
+    int dx = std::abs(x2 - x1);
+    int dy = std::abs(y2 - y1);
+    int sx = x1 < x2 ? 1 : -1;
+    int sy = y1 < y2 ? 1 : -1;
+
+    int p;
+    int x = x1;
+    int y = y1;
+
+    if (dx >= dy) {
+        p = 2 * dy - dx;
+        for (int i = 0; i < dx; i++) {
+            fb_plot(x, y);
+            if (p < 0) {
+                p += 2 * dy;
+            } else {
+                p += 2 * (dy - dx);
+                y += sy;
+            }
+            x += sx;
+        }
+    } else {
+        p = 2 * dx - dy;
+        for (int i = 0; i < dy; i++) {
+            fb_plot(x, y);
+            if (p < 0) {
+                p += 2 * dx;
+            } else {
+                p += 2 * (dx - dy);
+                x += sx;
+            }
+            y += sy;
+        }
+    }
+    fb_plot(x, y);
+}
 
+// Rounds a clipped coordinate to the nearest pixel. Float error on huge
+// inputs can leave it slightly outside the clip rectangle, so it is clamped
+// before lround to keep the result inside the framebuffer.
+inline int snap(float v, int lo, int hi) {
+    if (v < lo) return lo;
+    if (v > hi) return hi;
+    return (int)std::lround(v);
+}
+
+// Fused stage: clips each segment with Liang–Barsky and rasterizes the
+// clipped span right away; the clipped endpoints never leave locals.
+// Returns the number of segments that reached the framebuffer.
+size_t clip_and_rasterize(const LineSegment *segs, int count) {
+    // Clip against the user window intersected with the framebuffer, so the
+    // Bresenham loop is bounded by the buffer size and its terms fit in int.
+    float rxmin = std::max(xmin, (float)FB_ORIGIN_X);
+    float rymin = std::max(ymin, (float)FB_ORIGIN_Y);
+    float rxmax = std::min(xmax, (float)FB_LAST_X);
+    float rymax = std::min(ymax, (float)FB_LAST_Y);
+    if (!(rxmin <= rxmax && rymin <= rymax)) return 0;
+
+    size_t visible = 0;
+
+    for (int i = 0; i < count; ++i) {
+        float x0 = segs[i].p1.x, y0 = segs[i].p1.y;
+        float x1 = segs[i].p2.x, y1 = segs[i].p2.y;
         float t0, t1;
 
+        if (!liang_barsky_rect(rxmin, rymin, rxmax, rymax, x0, y0, x1, y1, t0, t1)) continue;
+
+        // Each clipped end is interpolated from its own endpoint, so an end
+        // that was not clipped (t0 == 0 or t1 == 1) stays bit-exact.
+        float cx0 = x0 + t0 * (x1 - x0), cy0 = y0 + t0 * (y1 - y0);
+        float cx1 = x1 - (1.0f - t1) * (x1 - x0), cy1 = y1 - (1.0f - t1) * (y1 - y0);
+        if (std::isnan(cx0) || std::isnan(cy0) || std::isnan(cx1) || std::isnan(cy1)) continue;
+
+        // Both ends are snapped the same way so that segments sharing an
+        // unclipped endpoint land on the same pixel regardless of direction.
+        int ix0 = snap(cx0, FB_ORIGIN_X, FB_LAST_X);
+        int iy0 = snap(cy0, FB_ORIGIN_Y, FB_LAST_Y);
+        int ix1 = snap(cx1, FB_ORIGIN_X, FB_LAST_X);
+        int iy1 = snap(cy1, FB_ORIGIN_Y, FB_LAST_Y);
+
+        bresenham_fb(ix0, iy0, ix1, iy1);
+        ++visible;
+    }
+    return visible;
+}
+
+// Worker side of the snapshot mailbox: copies the partial raster out only
+// after the GL thread has taken the previous one.
+void publish_raster_snapshot() {
+    if (!snapshot_wanted.load(std::memory_order_acquire)) return;
+    std::copy(framebuffer.begin(), framebuffer.end(), raster_snapshot.begin());
+    snapshot_wanted.store(false, std::memory_order_relaxed);
+    snapshot_generation.fetch_add(1, std::memory_order_release);
+}
+
+// GL side: takes a new snapshot if one is waiting and asks for the next.
+void take_raster_snapshot() {
+    unsigned gen = snapshot_generation.load(std::memory_order_acquire);
+    if (gen == shown_generation) return;
+    raster_front = raster_snapshot;
+    shown_generation = gen;
+    snapshot_wanted.store(true, std::memory_order_release);
+}
+
+void draw_framebuffer(const std::vector<unsigned char> &pixels) {
+    // The world origin is the window centre and always a valid raster
+    // position; a zero-size glBitmap then moves it to the window's corner.
+    glRasterPos2i(0, 0);
+    glBitmap(0, 0, 0, 0, -WINDOW_WIDTH / 2.0f, -WINDOW_HEIGHT / 2.0f, nullptr);
+
+    // The projection stretches the drawing area over the whole window, so one
+    // texel covers about 1.43 x 1.10 pixels. With a non-integer zoom some
+    // texels get one more row or column than their neighbours, which makes
+    // 1-pixel Bresenham lines look slightly uneven in width.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelZoom(WINDOW_WIDTH / DRAWING_AREA_WIDTH, WINDOW_HEIGHT / DRAWING_AREA_HEIGHT);
+    glDrawPixels(FB_WIDTH, FB_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelZoom(1.0f, 1.0f);
+}
+
+// ------------------- Pipelined Ingestion -------------------
+const int BATCH_SIZE = 256;   // segments per batch
+const int RING_SLOTS = 64;    // must be a power of two
+const int PIPELINE_POLL_MS = 10;
+const size_t MAX_LABELED_POINTS = 48;
+
+struct SegmentBatch {
+    int count;
+    LineSegment segs[BATCH_SIZE];
+};
+
+// Bounded single-producer/single-consumer ring of batches. The producer
+// spins (yielding) while the ring is full, which gives the parser backpressure.
+struct BatchRing {
+    SegmentBatch slots[RING_SLOTS];
+    alignas(64) std::atomic<size_t> head{0}; // next slot to read (consumer)
+    alignas(64) std::atomic<size_t> tail{0}; // next slot to write (producer)
+    std::atomic<bool> closed{false};
+
+    bool try_push(const SegmentBatch &b) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == RING_SLOTS) return false;
+        slots[t & (RING_SLOTS - 1)] = b;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(SegmentBatch &b) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        b = slots[h & (RING_SLOTS - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+BatchRing batch_ring;
+
+// Results are stored in fixed-size chunks allocated as batches arrive, so the
+// line count header is never trusted for an up-front allocation. The chunk
+// table itself never reallocates, which lets display() index it while the
+// worker fills later chunks.
+const int CHUNK_SIZE = 64 * BATCH_SIZE;
+
+struct PipelineChunk {
+    LineSegment lines[CHUNK_SIZE];
+    ClipResult results[CHUNK_SIZE];
+};
+
+std::vector<std::unique_ptr<PipelineChunk>> pipeline_chunks;
+
+const LineSegment &pipeline_line(size_t i) {
+    return pipeline_chunks[i / CHUNK_SIZE]->lines[i % CHUNK_SIZE];
+}
+
+const ClipResult &pipeline_result(size_t i) {
+    return pipeline_chunks[i / CHUNK_SIZE]->results[i % CHUNK_SIZE];
+}
+
+// Waits for the other side of the ring: yields for a short while, then
+// sleeps so a stalled producer (e.g. a user typing lines) does not burn a core.
+void ring_backoff(int &spins) {
+    if (spins < 64) {
+        ++spins;
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// Returns false if the pipeline was stopped while the ring was full.
+bool push_batch(const SegmentBatch &b) {
+    int spins = 0;
+    while (!batch_ring.try_push(b)) {
+        if (pipeline_stop.load(std::memory_order_relaxed)) return false;
+        ring_backoff(spins);
+    }
+    return true;
+}
+
+// Producer: parses "x1 y1 x2 y2" records from stdin into fixed-size batches.
+// It only touches batch_ring, which has no destructor, so it can stay
+// detached and blocked in scanf when the program exits.
+void parse_segments(int n) {
+    SegmentBatch batch;
+    batch.count = 0;
+
+    for (int i = 0; i < n; ++i) {
+        float x1, y1, x2, y2;
+        if (std::scanf("%f %f %f %f", &x1, &y1, &x2, &y2) != 4) break;
+        batch.segs[batch.count++] = {{x1, y1}, {x2, y2}};
+        if (batch.count == BATCH_SIZE) {
+            if (!push_batch(batch)) return;
+            batch.count = 0;
+        }
+    }
+    if (batch.count > 0) push_batch(batch);
+    batch_ring.closed.store(true, std::memory_order_release);
+}
+
+// Consumer: clips each batch with Liang–Barsky and publishes the results.
+void clip_segments() {
+    SegmentBatch batch;
+    size_t next = 0;
+    int spins = 0;
+
+    while (!pipeline_stop.load(std::memory_order_relaxed)) {
+        // Read "closed" before popping so an empty pop after it means the ring is drained.
+        bool closed = batch_ring.closed.load(std::memory_order_acquire);
+        if (!batch_ring.try_pop(batch)) {
+            if (closed) break;
+            ring_backoff(spins);
+            continue;
+        }
+        spins = 0;
+
+        if (use_raster) {
+            rasterized_visible += clip_and_rasterize(batch.segs, batch.count);
+            next += batch.count;
+            publish_raster_snapshot();
+        } else {
+            for (int i = 0; i < batch.count; ++i, ++next) {
+                std::unique_ptr<PipelineChunk> &chunk = pipeline_chunks[next / CHUNK_SIZE];
+                if (!chunk) chunk.reset(new PipelineChunk);
+                chunk->lines[next % CHUNK_SIZE] = batch.segs[i];
+                chunk->results[next % CHUNK_SIZE] = clip_segment(batch.segs[i]);
+            }
+        }
+        published_count.store(next, std::memory_order_release);
+    }
+    if (use_raster) raster_ready.store(true, std::memory_order_release);
+    pipeline_done.store(true, std::memory_order_release);
+}
+
+void start_pipeline(int n) {
+    // Only the chunk table is sized from n, so even a huge count costs little up front.
+    if (use_raster)
+        raster_snapshot = framebuffer;
+    else
+        pipeline_chunks.resize(((size_t)n + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    std::thread(parse_segments, n).detach();
+    clip_thread = std::thread(clip_segments);
+}
+
+// Called after glutMainLoop returns: the clip worker writes into globals
+// that are destroyed at exit, so it must be stopped and joined first.
+void stop_pipeline() {
+    pipeline_stop.store(true, std::memory_order_relaxed);
+    if (clip_thread.joinable()) clip_thread.join();
+}
+
+// Draws segments [begin, end) on top of the current frame, then labels the
+// visible points they added.
+void draw_segments(size_t begin, size_t end) {
+    size_t first_label = visible_points.size();
+
+    for (size_t i = begin; i < end; ++i) {
+        const LineSegment &line = use_pipeline ? pipeline_line(i) : lines_to_clip[i];
+        ClipResult r = use_pipeline ? pipeline_result(i) : clip_segment(line);
+
         // Original line (soft red)
         glColor3f(0.9f, 0.3f, 0.3f);
         glLineWidth(1.0f);
         glBegin(GL_LINES);
-        glVertex2f(x0, y0);
-        glVertex2f(x1, y1);
+        glVertex2f(line.p1.x, line.p1.y);
+        glVertex2f(line.p2.x, line.p2.y);
         glEnd();
 
-        if (liang_barsky(x0, y0, x1, y1, t0, t1)) {
-            float cx0 = x0 + t0 * (x1 - x0);
-            float cy0 = y0 + t0 * (y1 - y0);
-            float cx1 = x0 + t1 * (x1 - x0);
-            float cy1 = y0 + t1 * (y1 - y0);
-
-            visible_points.push_back({cx0, cy0});
-            visible_points.push_back({cx1, cy1});
+        if (r.visible) {
+            float cx0 = r.clipped.p1.x, cy0 = r.clipped.p1.y;
+            float cx1 = r.clipped.p2.x, cy1 = r.clipped.p2.y;
 
             // Clipped segment (orange)
             glColor3f(1.0f, 0.6f, 0.0f);
@@ -206,16 +540,24 @@ void display() {
             glVertex2f(cx0, cy0);
             glVertex2f(cx1, cy1);
             glEnd();
+
+            // The pipeline redraws incrementally, so it only keeps as many
+            // points as the side panel can list.
+            if (!use_pipeline || visible_points.size() < MAX_LABELED_POINTS)
+                visible_points.push_back({cx0, cy0});
+            if (!use_pipeline || visible_points.size() < MAX_LABELED_POINTS)
+                visible_points.push_back({cx1, cy1});
         }
     }
 
     // Label visible points
-    for (size_t i = 0; i < visible_points.size(); ++i) {
+    for (size_t i = first_label; i < visible_points.size(); ++i) {
         std::string lbl = "P" + std::to_string(i + 1);
         draw_text(visible_points[i].x + 8, visible_points[i].y + 8, 0.4f, 0.0f, 0.6f, lbl, GLUT_BITMAP_HELVETICA_12);
     }
+}
 
-    // Right panel
+void draw_side_panel() {
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
     glLoadIdentity();
@@ -238,11 +580,26 @@ void display() {
     glVertex2f(startX, DRAWING_AREA_HEIGHT);
     glEnd();
 
-    draw_text(startX + 15, DRAWING_AREA_HEIGHT - 20, 0.1f, 0.3f, 0.3f, "Visible Points:", GLUT_BITMAP_HELVETICA_12);
-
-    float y = DRAWING_AREA_HEIGHT - 40;
     std::ostringstream ss;
     ss << std::fixed << std::setprecision(1);
+
+    if (use_raster) {
+        draw_text(startX + 15, DRAWING_AREA_HEIGHT - 20, 0.1f, 0.3f, 0.3f, "Software Raster:", GLUT_BITMAP_HELVETICA_12);
+
+        size_t done = use_pipeline ? published_count.load(std::memory_order_acquire) : lines_to_clip.size();
+        ss << "Segments processed: " << done;
+        draw_text(startX + 15, DRAWING_AREA_HEIGHT - 40, 0.0f, 0.0f, 0.0f, ss.str(), GLUT_BITMAP_HELVETICA_10);
+
+        if (raster_ready.load(std::memory_order_acquire)) {
+            ss.str("");
+            ss << "Visible segments: " << rasterized_visible;
+            draw_text(startX + 15, DRAWING_AREA_HEIGHT - 55, 0.0f, 0.0f, 0.0f, ss.str(), GLUT_BITMAP_HELVETICA_10);
+        }
+    } else {
+        draw_text(startX + 15, DRAWING_AREA_HEIGHT - 20, 0.1f, 0.3f, 0.3f, "Visible Points:", GLUT_BITMAP_HELVETICA_12);
+    }
+
+    float y = DRAWING_AREA_HEIGHT - 40;
     for (size_t i = 0; i < visible_points.size(); ++i) {
         ss.str("");
         ss << "P" << (i + 1) << " (" << visible_points[i].x << ", " << visible_points[i].y << ")";
@@ -254,6 +611,57 @@ void display() {
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
     glMatrixMode(GL_MODELVIEW);
+}
+
+// Polls the pipeline while it is still producing and draws only the newly
+// published range; display() still does the full redraw on expose.
+void pipeline_timer(int) {
+    // Read "done" first so the count loaded after it is final.
+    bool done = pipeline_done.load(std::memory_order_acquire);
+    size_t count = published_count.load(std::memory_order_acquire);
+
+    if (use_raster) {
+        take_raster_snapshot();
+        glutPostRedisplay(); // one glDrawPixels, no per-segment GL work
+    } else if (count > drawn_count) {
+        draw_segments(drawn_count, count);
+        drawn_count = count;
+        draw_side_panel();
+        glFlush();
+    }
+
+    if (!done) glutTimerFunc(PIPELINE_POLL_MS, pipeline_timer, 0);
+}
+
+// ------------------- Display -------------------
+void display() {
+    glClear(GL_COLOR_BUFFER_BIT);
+    visible_points.clear();
+
+    if (use_raster) {
+        if (raster_ready.load(std::memory_order_acquire))
+            draw_framebuffer(framebuffer);
+        else if (shown_generation != 0)
+            draw_framebuffer(raster_front);
+    }
+
+    draw_ui_header(
+        "Liang–Barsky Line Clipping (Modified Version)",
+        "Clipping Window: (" + std::to_string(xmin) + "," + std::to_string(ymin) +
+        ") → (" + std::to_string(xmax) + "," + std::to_string(ymax) + ")",
+        0.0f, 0.4f, 0.7f
+    );
+
+    draw_coordinate_system();
+    draw_clipping_window();
+
+    size_t line_count = lines_to_clip.size();
+    if (use_raster) line_count = 0; // clipped spans are already in the framebuffer
+    else if (use_pipeline) line_count = published_count.load(std::memory_order_acquire);
+
+    draw_segments(0, line_count);
+    drawn_count = line_count;
+    draw_side_panel();
 
     glFlush();
 }
@@ -268,6 +676,16 @@ void take_input() {
 
     std::cout << "Number of lines: ";
     std::cin >> n;
+    if (n < 0) {
+        std::cout << "Negative line count, no lines will be read." << std::endl;
+        n = 0;
+    }
+
+    if (use_pipeline) {
+        std::cout << "Enter " << n << " lines as x1 y1 x2 y2 (parsed in the background)" << std::endl;
+        start_pipeline(n);
+        return;
+    }
 
     for (int i = 0; i < n; ++i) {
         float x1, y1, x2, y2;
@@ -288,14 +706,33 @@ void init() {
 
 // ------------------- Main -------------------
 int main(int argc, char** argv) {
+    // --pipeline: parse and clip lines on background threads while the window is up
+    // --raster:   clip and rasterize into a software framebuffer instead of GL_LINES
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--pipeline") == 0) use_pipeline = true;
+        else if (std::strcmp(argv[i], "--raster") == 0) use_raster = true;
+        else argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    if (use_raster) clear_framebuffer();
     take_input();
+    if (use_raster && !use_pipeline) {
+        rasterized_visible = clip_and_rasterize(lines_to_clip.data(), (int)lines_to_clip.size());
+        raster_ready.store(true, std::memory_order_release);
+    }
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
     glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
     glutInitWindowPosition(100, 100);
+    // Return from glutMainLoop on close so the pipeline can be shut down cleanly.
+    glutSetOption(GLUT_ACTION_ON_WINDOW_CLOSE, GLUT_ACTION_GLUTMAINLOOP_RETURNS);
     glutCreateWindow("Liang–Barsky Line Clipping (Modified)");
     init();
     glutDisplayFunc(display);
+    if (use_pipeline) glutTimerFunc(PIPELINE_POLL_MS, pipeline_timer, 0);
     glutMainLoop();
+    if (use_pipeline) stop_pipeline();
     return 0;
 }